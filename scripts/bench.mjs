@@ -0,0 +1,221 @@
+// Local web-performance benchmark for the built site (./scripts/run.sh --bench).
+//
+// Serves dist/ locally, loads every page in src/pages in headless Chrome
+// under throttled mobile profiles and records LCP, CLS, TBT, transfer bytes
+// and request counts over several cold-cache runs. Medians are written to
+// bench-results/ as JSON and Markdown (timestamped, plus latest.*).
+// Analytics requests are blocked so runs never reach Google.
+//
+// Usage: node scripts/bench.mjs [--runs 3] [--profile mobile-slow-4g,mobile-3g]
+//                               [--pages /,/faq] [--out bench-results]
+
+import { execFileSync } from "node:child_process";
+import { mkdir, readdir, writeFile } from "node:fs/promises";
+import { join } from "node:path";
+import { parseArgs } from "node:util";
+import { launchChrome } from "./lib/chrome.mjs";
+import { ROOT, formatBytes } from "./lib/dist.mjs";
+import { serveDist } from "./lib/serve.mjs";
+
+// Modelled on Lighthouse's mobile presets (Moto G Power class device)
+const MOBILE_VIEWPORT = { width: 412, height: 823, deviceScaleFactor: 1.75, mobile: true };
+const MOBILE_UA =
+  "Mozilla/5.0 (Linux; Android 11; moto g power (2022)) AppleWebKit/537.36 " +
+  "(KHTML, like Gecko) Chrome/120.0.0.0 Mobile Safari/537.36";
+
+export const PROFILES = {
+  "mobile-slow-4g": {
+    viewport: MOBILE_VIEWPORT,
+    cpuSlowdown: 4,
+    network: { latency: 150, downloadThroughput: (1.6 * 1024 * 1024) / 8, uploadThroughput: (750 * 1024) / 8 },
+  },
+  "mobile-3g": {
+    viewport: MOBILE_VIEWPORT,
+    cpuSlowdown: 6,
+    network: { latency: 300, downloadThroughput: (700 * 1024) / 8, uploadThroughput: (700 * 1024) / 8 },
+  },
+};
+
+const BLOCKED = ["*googletagmanager.com*", "*google-analytics.com*"];
+const NETWORK_QUIET_MS = 1500;
+const SETTLE_TIMEOUT_MS = 20000;
+
+// Runs in the page before any of its scripts
+const OBSERVERS = `(() => {
+  const m = (window.__bench = { fcp: 0, lcp: 0, cls: 0, longTasks: [] });
+  const observe = (type, fn) => {
+    try {
+      new PerformanceObserver((list) => list.getEntries().forEach(fn)).observe({ type, buffered: true });
+    } catch {}
+  };
+  observe("paint", (e) => { if (e.name === "first-contentful-paint") m.fcp = e.startTime; });
+  observe("largest-contentful-paint", (e) => { m.lcp = e.renderTime || e.loadTime || e.startTime; });
+  observe("longtask", (e) => m.longTasks.push([e.startTime, e.duration]));
+  // CLS: largest session window (gaps < 1s, windows <= 5s)
+  let windowValue = 0, windowStart = 0, last = 0;
+  observe("layout-shift", (e) => {
+    if (e.hadRecentInput) return;
+    if (e.startTime - last > 1000 || e.startTime - windowStart > 5000) {
+      windowValue = 0;
+      windowStart = e.startTime;
+    }
+    windowValue += e.value;
+    last = e.startTime;
+    m.cls = Math.max(m.cls, windowValue);
+  });
+})();`;
+
+export async function discoverPages() {
+  const files = await readdir(join(ROOT, "src", "pages"));
+  return files
+    .filter((file) => file.endsWith(".astro"))
+    .map((file) => (file === "index.astro" ? "/" : `/${file.replace(/\.astro$/, "")}`))
+    .sort();
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = Math.floor(sorted.length / 2);
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+async function measure(browser, url, profile) {
+  const page = await browser.newPage();
+  try {
+    const { viewport, cpuSlowdown, network } = profile;
+    await page.send("Network.enable");
+    await page.send("Network.setCacheDisabled", { cacheDisabled: true });
+    await page.send("Network.setBlockedURLs", { urls: BLOCKED });
+    await page.send("Network.emulateNetworkConditions", { offline: false, ...network });
+    await page.send("Emulation.setDeviceMetricsOverride", viewport);
+    await page.send("Emulation.setUserAgentOverride", { userAgent: MOBILE_UA });
+    await page.send("Emulation.setTouchEmulationEnabled", { enabled: true });
+    await page.send("Emulation.setCPUThrottlingRate", { rate: cpuSlowdown });
+    await page.send("Page.addScriptToEvaluateOnNewDocument", { source: OBSERVERS });
+
+    const origin = new URL(url).origin;
+    const requests = new Map();
+    const inflight = new Set();
+    let lastActivity = Date.now();
+    const track = (id, done) => {
+      done ? inflight.delete(id) : inflight.add(id);
+      lastActivity = Date.now();
+    };
+    page.on("Network.requestWillBeSent", ({ requestId, request }) => {
+      if (request.url.startsWith("data:")) return;
+      requests.set(requestId, { url: request.url, bytes: 0 });
+      track(requestId, false);
+    });
+    page.on("Network.loadingFinished", ({ requestId, encodedDataLength }) => {
+      const entry = requests.get(requestId);
+      if (entry) entry.bytes = encodedDataLength;
+      track(requestId, true);
+    });
+    page.on("Network.loadingFailed", ({ requestId }) => track(requestId, true));
+
+    await page.goto(url);
+
+    // Let late work (idle callbacks, lazy images) finish before reading metrics
+    const deadline = Date.now() + SETTLE_TIMEOUT_MS;
+    while (Date.now() < deadline && (inflight.size > 0 || Date.now() - lastActivity < NETWORK_QUIET_MS)) {
+      await new Promise((resolve) => setTimeout(resolve, 100));
+    }
+
+    const metrics = await page.evaluate("window.__bench");
+    const tbt = metrics.longTasks
+      .filter(([start]) => start >= metrics.fcp)
+      .reduce((sum, [, duration]) => sum + Math.max(0, duration - 50), 0);
+    const entries = [...requests.values()];
+
+    return {
+      fcp: Math.round(metrics.fcp),
+      lcp: Math.round(metrics.lcp),
+      cls: Number(metrics.cls.toFixed(4)),
+      tbt: Math.round(tbt),
+      transferBytes: entries.reduce((sum, entry) => sum + entry.bytes, 0),
+      requests: entries.length,
+      thirdPartyRequests: entries.filter((entry) => !entry.url.startsWith(origin)).length,
+    };
+  } finally {
+    await page.close();
+  }
+}
+
+function toMarkdown(report) {
+  const lines = [
+    `# Benchmark ${report.date}`,
+    "",
+    `Commit \`${report.commit ?? "unknown"}\`, ${report.runs} cold runs per page and profile, medians shown.`,
+    "",
+    "| Page | Profile | LCP | CLS | TBT | Transfer | Requests |",
+    "| --- | --- | ---: | ---: | ---: | ---: | ---: |",
+  ];
+  for (const result of report.results) {
+    const m = result.median;
+    lines.push(
+      `| \`${result.page}\` | ${result.profile} | ${m.lcp} ms | ${m.cls.toFixed(3)} | ${m.tbt} ms | ` +
+        `${formatBytes(m.transferBytes)} | ${m.requests} |`,
+    );
+  }
+  return lines.join("\n") + "\n";
+}
+
+function gitCommit() {
+  try {
+    return execFileSync("git", ["rev-parse", "--short", "HEAD"], { cwd: ROOT }).toString().trim();
+  } catch {
+    return null;
+  }
+}
+
+async function main() {
+  const { values } = parseArgs({
+    options: {
+      runs: { type: "string", default: "3" },
+      profile: { type: "string", default: Object.keys(PROFILES).join(",") },
+      pages: { type: "string" },
+      out: { type: "string", default: join(ROOT, "bench-results") },
+    },
+  });
+  const runs = Number(values.runs);
+  const profiles = values.profile.split(",");
+  for (const name of profiles) {
+    if (!PROFILES[name]) throw new Error(`unknown profile "${name}" (have: ${Object.keys(PROFILES).join(", ")})`);
+  }
+  const pages = values.pages ? values.pages.split(",") : await discoverPages();
+
+  const server = await serveDist();
+  const browser = await launchChrome();
+  const results = [];
+  try {
+    for (const profile of profiles) {
+      for (const path of pages) {
+        const samples = [];
+        for (let run = 0; run < runs; run++) {
+          samples.push(await measure(browser, server.origin + path, PROFILES[profile]));
+        }
+        const med = Object.fromEntries(Object.keys(samples[0]).map((key) => [key, median(samples.map((s) => s[key]))]));
+        results.push({ page: path, profile, median: med, samples });
+        console.log(
+          `[bench] ${profile.padEnd(15)} ${path.padEnd(18)} LCP ${String(med.lcp).padStart(5)} ms  ` +
+            `CLS ${med.cls.toFixed(3)}  TBT ${String(med.tbt).padStart(4)} ms  ` +
+            `${formatBytes(med.transferBytes).padStart(9)}  ${med.requests} req`,
+        );
+      }
+    }
+  } finally {
+    await browser.close();
+    await server.close();
+  }
+
+  const report = { date: new Date().toISOString(), commit: gitCommit(), runs, profiles, results };
+  const stamp = report.date.replace(/[:.]/g, "-");
+  await mkdir(values.out, { recursive: true });
+  for (const name of [`bench-${stamp}`, "latest"]) {
+    await writeFile(join(values.out, `${name}.json`), JSON.stringify(report, null, 2) + "\n");
+    await writeFile(join(values.out, `${name}.md`), toMarkdown(report));
+  }
+  console.log(`[bench] report written to ${join(values.out, "latest.md")}`);
+}
+
+await main();
@@ -0,0 +1,201 @@
+// Checks every built page against the per-route budgets in
+// scripts/budgets.json and against the last passing build's snapshot,
+// prints a diff table and exits non-zero when a page is over budget. Runs after
+// compress.mjs in postbuild so text sizes are the Brotli bytes a browser
+// actually downloads.
+//
+// A page's weight is its HTML plus the subresources it loads up front:
+// stylesheets, scripts, preloads, one candidate per image (the largest
+// candidate of the first <source> in a <picture>, which is what a 2x
+// screen fetches) and the fonts its stylesheets reference. Third-party
+// origins are counted from external src/href attributes, including
+// preconnect and dns-prefetch hints.
+
+import { existsSync } from "node:fs";
+import { mkdir, readFile, stat, writeFile } from "node:fs/promises";
+import { join } from "node:path";
+import {
+  DIST,
+  ROOT,
+  attr,
+  extractUrls,
+  fileToRoute,
+  formatBytes,
+  largestCandidate,
+  toUrlPath,
+  walk,
+} from "./lib/dist.mjs";
+
+const SITE = "https://brewos.io";
+const SNAPSHOT = join(ROOT, "node_modules", ".cache", "brewos", "budgets-snapshot.json");
+const BYTE_METRICS = ["html", "css", "js", "image", "font"];
+const COUNT_METRICS = ["requests", "thirdPartyOrigins"];
+
+const KIND = [
+  ["css", /\.css$/],
+  ["js", /\.m?js$/],
+  ["font", /\.(woff2?|ttf|otf)$/],
+  ["image", /\.(avif|webp|png|jpe?g|gif|svg|ico)$/],
+];
+
+function kindOf(url) {
+  return KIND.find(([, pattern]) => pattern.test(url))?.[0] ?? null;
+}
+
+function sameOrigin(url) {
+  if (url.startsWith(SITE)) url = url.slice(SITE.length);
+  if (!url.startsWith("/") || url.startsWith("//")) return null;
+  return url.split(/[?#]/)[0];
+}
+
+/** Subresource URLs (site-relative) and third-party origins loaded by a page. */
+function pageResources(html) {
+  const urls = new Set();
+  const origins = new Set();
+  const add = (url) => {
+    if (!url || url.startsWith("data:")) return;
+    const local = sameOrigin(url);
+    if (local) urls.add(local);
+    else if (/^(https?:)?\/\//.test(url)) origins.add(new URL(url, SITE).origin);
+  };
+
+  // <template> content (the mobile menu) isn't loaded with the page
+  html = html.replace(/<template[\s\S]*?<\/template>/g, "");
+
+  // <picture>: the browser fetches a single candidate, from the first source
+  const rest = html.replace(/<picture[\s\S]*?<\/picture>/g, (picture) => {
+    const source = picture.match(/<source\s[^>]*>/)?.[0];
+    const img = picture.match(/<img\s[^>]*>/)?.[0] ?? "";
+    const srcset = (source && attr(source, "srcset")) ?? attr(img, "srcset");
+    add(srcset ? largestCandidate(srcset) : attr(img, "src"));
+    return "";
+  });
+
+  for (const [tag] of rest.matchAll(/<img\s[^>]*>/g)) {
+    const srcset = attr(tag, "srcset");
+    add(srcset ? largestCandidate(srcset) : attr(tag, "src"));
+  }
+  for (const [tag] of rest.matchAll(/<(?:script|iframe)\s[^>]*>/g)) add(attr(tag, "src"));
+  for (const [tag] of rest.matchAll(/<use\s[^>]*>/g)) add(attr(tag, "href"));
+  for (const [tag] of rest.matchAll(/<link\s[^>]*>/g)) {
+    const rel = (attr(tag, "rel") ?? "").split(/\s+/);
+    const href = attr(tag, "href");
+    if (rel.some((r) => ["preconnect", "dns-prefetch"].includes(r))) {
+      if (href && !sameOrigin(href)) origins.add(new URL(href, SITE).origin);
+    } else if (rel.some((r) => ["stylesheet", "preload", "modulepreload"].includes(r))) {
+      add(href);
+    }
+  }
+  return { urls, origins };
+}
+
+const sizes = new Map();
+
+// Transfer size: the .br sibling written by compress.mjs when there is one
+async function transferSize(url) {
+  if (!sizes.has(url)) {
+    const file = join(DIST, decodeURIComponent(url));
+    const compressed = `${file}.br`;
+    sizes.set(url, existsSync(compressed) ? (await stat(compressed)).size : existsSync(file) ? (await stat(file)).size : null);
+  }
+  return sizes.get(url);
+}
+
+async function measure(file) {
+  const html = await readFile(file, "utf8");
+  const { urls, origins } = pageResources(html);
+  const totals = Object.fromEntries(BYTE_METRICS.map((metric) => [metric, 0]));
+  totals.html = await transferSize(toUrlPath(file));
+
+  // Fonts come in through the stylesheets rather than the HTML
+  for (const url of [...urls]) {
+    if (kindOf(url) !== "css" || !existsSync(join(DIST, url))) continue;
+    for (const ref of extractUrls(await readFile(join(DIST, url), "utf8"), SITE)) {
+      if (kindOf(ref) === "font") urls.add(ref);
+    }
+  }
+
+  const missing = [];
+  for (const url of urls) {
+    const kind = kindOf(url);
+    if (!kind) continue;
+    const size = await transferSize(url);
+    if (size === null) missing.push(url);
+    else totals[kind] += size;
+  }
+  return {
+    ...totals,
+    requests: 1 + [...urls].filter((url) => kindOf(url)).length,
+    thirdPartyOrigins: origins.size,
+    origins: [...origins].sort(),
+    missing,
+  };
+}
+
+function formatMetric(metric, value) {
+  return BYTE_METRICS.includes(metric) ? formatBytes(value) : String(value);
+}
+
+function formatDelta(metric, delta) {
+  if (delta === null) return "new";
+  if (delta === 0) return "±0";
+  return (delta > 0 ? "+" : "-") + formatMetric(metric, Math.abs(delta));
+}
+
+const config = JSON.parse(await readFile(join(ROOT, "scripts", "budgets.json"), "utf8"));
+const previous = existsSync(SNAPSHOT) ? JSON.parse(await readFile(SNAPSHOT, "utf8")) : null;
+
+const pages = (await walk(DIST)).filter((file) => file.endsWith(".html") && !file.endsWith("404.html"));
+const current = {};
+for (const file of pages) current[fileToRoute(file)] = await measure(file);
+
+const failures = [];
+for (const route of Object.keys(config.routes)) {
+  if (!current[route]) failures.push(`${route}: has a budget but was not built`);
+}
+
+const header = ["route", "metric", "size", "previous", "delta", "budget", ""];
+const rows = [];
+for (const route of Object.keys(current).sort()) {
+  const budget = { ...config.default, ...config.routes[route] };
+  if (!config.routes[route]) console.warn(`[budgets] ${route} has no budget of its own; using the default`);
+  for (const url of current[route].missing) failures.push(`${route}: references missing file ${url}`);
+
+  for (const metric of [...BYTE_METRICS, ...COUNT_METRICS]) {
+    const value = current[route][metric];
+    const before = previous?.routes[route]?.[metric] ?? null;
+    const limit = BYTE_METRICS.includes(metric) ? budget[metric] * 1024 : budget[metric];
+    const over = limit !== undefined && value > limit;
+    if (over) {
+      const detail = metric === "thirdPartyOrigins" ? ` (${current[route].origins.join(", ")})` : "";
+      failures.push(`${route}: ${metric} ${formatMetric(metric, value)} exceeds ${formatMetric(metric, limit)}${detail}`);
+    }
+    rows.push([
+      rows.some(([r]) => r === route) ? "" : route,
+      metric,
+      formatMetric(metric, value),
+      before === null ? "-" : formatMetric(metric, before),
+      formatDelta(metric, before === null ? null : value - before),
+      limit === undefined ? "-" : formatMetric(metric, limit),
+      over ? "OVER" : "",
+    ]);
+  }
+}
+
+const widths = header.map((_, i) => Math.max(...[header, ...rows].map((row) => row[i].length)));
+const line = (row) => row.map((cell, i) => (i < 2 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]))).join("  ");
+console.log(`[budgets] compared with ${previous ? `build of ${previous.date}` : "no previous snapshot"}`);
+console.log(`[budgets] ${line(header)}`);
+for (const row of rows) console.log(`[budgets] ${line(row)}`);
+
+// A failing build never becomes the baseline, or the next run's diff would
+// hide the regression
+if (failures.length) {
+  console.error(`\n[budgets] ${failures.length} budget violation(s):`);
+  for (const failure of failures) console.error(`[budgets]   ${failure}`);
+  process.exit(1);
+}
+
+await mkdir(join(SNAPSHOT, ".."), { recursive: true });
+await writeFile(SNAPSHOT, JSON.stringify({ date: new Date().toISOString(), routes: current }, null, 2) + "\n");
+console.log(`[budgets] all ${Object.keys(current).length} pages within budget`);
@@ -0,0 +1,82 @@
+// Writes maximum-level .br, .gz and .zst siblings next to every compressible
+// file in dist/, so hosts and preview servers that support precompressed
+// static files never compress on the fly. Runs after every step that rewrites
+// dist/ (check-budgets.mjs reads the .br sizes).
+//
+// zstd uses node:zlib when available (Node >= 22.15) and otherwise the
+// `zstd` CLI; if neither exists the .zst files are skipped with a warning.
+
+import { spawnSync } from "node:child_process";
+import { readFile, writeFile } from "node:fs/promises";
+import { relative } from "node:path";
+import zlib from "node:zlib";
+import { DIST, formatBytes, walk } from "./lib/dist.mjs";
+
+const COMPRESSIBLE = /\.(html|css|js|mjs|svg|xml|json|webmanifest)$/;
+
+function brotli(data) {
+  return zlib.brotliCompressSync(data, {
+    params: {
+      [zlib.constants.BROTLI_PARAM_MODE]: zlib.constants.BROTLI_MODE_TEXT,
+      [zlib.constants.BROTLI_PARAM_QUALITY]: zlib.constants.BROTLI_MAX_QUALITY,
+      [zlib.constants.BROTLI_PARAM_LGWIN]: zlib.constants.BROTLI_MAX_WINDOW_BITS,
+      [zlib.constants.BROTLI_PARAM_SIZE_HINT]: data.length,
+    },
+  });
+}
+
+function gzip(data) {
+  return zlib.gzipSync(data, { level: zlib.constants.Z_BEST_COMPRESSION, memLevel: 9 });
+}
+
+function zstdCompressor() {
+  if (typeof zlib.zstdCompressSync === "function") {
+    return (data) =>
+      zlib.zstdCompressSync(data, {
+        params: { [zlib.constants.ZSTD_c_compressionLevel]: 22 },
+      });
+  }
+  if (spawnSync("zstd", ["--version"]).status === 0) {
+    return (data) => {
+      const result = spawnSync("zstd", ["--ultra", "-22", "-c", "-q"], { input: data, maxBuffer: 1 << 30 });
+      if (result.status !== 0) throw new Error(`zstd failed: ${result.stderr}`);
+      return result.stdout;
+    };
+  }
+  console.warn("[compress] no zstd support (needs Node >= 22.15 or the zstd CLI); skipping .zst");
+  return null;
+}
+
+const encoders = [
+  ["br", brotli],
+  ["gz", gzip],
+  ["zst", zstdCompressor()],
+].filter(([, encode]) => encode);
+
+const totals = { original: 0 };
+const rows = [];
+
+for (const file of (await walk(DIST)).filter((f) => COMPRESSIBLE.test(f))) {
+  const data = await readFile(file);
+  const row = { file: relative(DIST, file), original: data.length };
+  totals.original += data.length;
+
+  for (const [ext, encode] of encoders) {
+    const packed = encode(data);
+    row[ext] = packed.length;
+    totals[ext] = (totals[ext] ?? 0) + packed.length;
+    await writeFile(`${file}.${ext}`, packed);
+  }
+  rows.push(row);
+}
+
+const pct = (size, original) => `${(100 - (size / original) * 100).toFixed(1).padStart(5)}%`;
+const width = Math.max(4, ...rows.map((r) => r.file.length));
+
+console.log(`[compress] ${"file".padEnd(width)}  ${"size".padStart(9)}  ${encoders.map(([e]) => e.padStart(18)).join("")}`);
+for (const row of [...rows, { file: "total", ...totals }]) {
+  const cells = encoders
+    .map(([ext]) => `${formatBytes(row[ext]).padStart(10)} ${pct(row[ext], row.original)}`.padStart(18))
+    .join("");
+  console.log(`[compress] ${row.file.padEnd(width)}  ${formatBytes(row.original).padStart(9)}  ${cells}`);
+}
@@ -0,0 +1,177 @@
+// Inlines each page's above-the-fold CSS and loads its stylesheets
+// asynchronously, so first paint doesn't wait for the full bundle.
+//
+// Every page in dist/ is rendered in headless Chrome at a mobile and a
+// desktop viewport. Rules from the page's own stylesheets that match
+// anything in the first viewport at either size (plus @font-face and the
+// @keyframes those rules use) go into a <style data-critical> in <head>;
+// the <link rel="stylesheet"> tags become preloads that switch themselves
+// on, with a <noscript> fallback. Runs after fingerprint-assets.mjs and
+// before the service worker and compression steps.
+//
+// Needs Chrome (see scripts/lib/chrome.mjs). In CI (CI is set) a Chrome
+// that is missing or fails to start fails the build, so no deploy quietly
+// ships render-blocking stylesheets; local builds leave the pages as they are
+// and carry on.
+
+import { readFile, writeFile } from "node:fs/promises";
+import { gzipSync } from "node:zlib";
+import { launchChrome } from "./lib/chrome.mjs";
+import { DIST, fileToRoute, formatBytes, walk } from "./lib/dist.mjs";
+import { serveDist } from "./lib/serve.mjs";
+
+export const VIEWPORTS = [
+  { name: "mobile", width: 412, height: 823, deviceScaleFactor: 2, mobile: true },
+  { name: "desktop", width: 1350, height: 940, deviceScaleFactor: 1, mobile: false },
+];
+
+const BLOCKED = ["*googletagmanager.com*", "*google-analytics.com*", "*cloud.brewos.io*"];
+const STYLESHEET = /<link\s[^>]*rel=["']stylesheet["'][^>]*>/g;
+
+// Runs in the page: index paths ("<sheet>.<rule>.<rule>...") of the rules
+// in same-origin stylesheets that apply to something in the first viewport
+function collectCritical() {
+  const fold = innerHeight;
+  const PSEUDO_ELEMENT = /::?(?:before|after|first-line|first-letter)\b|::[a-z-]+(?:\([^)]*\))?/gi;
+  const DYNAMIC = /:(?:hover|focus(?:-visible|-within)?|active|visited|target|checked|disabled)\b/g;
+
+  function aboveFold(selector) {
+    const cleaned = selector.replace(PSEUDO_ELEMENT, "").replace(DYNAMIC, "").trim() || "*";
+    let elements;
+    try {
+      elements = document.querySelectorAll(cleaned);
+    } catch {
+      return true;
+    }
+    for (const element of elements) {
+      // Hidden elements report an empty box at the top, so they don't count:
+      // desktop-only nav on mobile, collapsed panels and the like. A rule
+      // that hides something visible up here still matches that element.
+      const box = element.getBoundingClientRect();
+      if ((box.width || box.height) && box.top < fold) return true;
+    }
+    return false;
+  }
+
+  const keys = [];
+  function walk(rules, path) {
+    Array.from(rules).forEach((rule, i) => {
+      const key = `${path}.${i}`;
+      if (rule instanceof CSSStyleRule) {
+        if (aboveFold(rule.selectorText)) keys.push(key);
+      } else if (rule instanceof CSSMediaRule) {
+        if (matchMedia(rule.media.mediaText).matches) walk(rule.cssRules, key);
+      } else if (rule instanceof CSSSupportsRule) {
+        if (CSS.supports(rule.conditionText)) walk(rule.cssRules, key);
+      } else if (!(rule instanceof CSSKeyframesRule)) {
+        // @font-face, @property, @starting-style, ...: keep as they are
+        keys.push(key);
+      }
+    });
+  }
+
+  scrollTo(0, 0);
+  Array.from(document.styleSheets).forEach((sheet, i) => {
+    if (sheet.href && new URL(sheet.href).origin === location.origin) walk(sheet.cssRules, String(i));
+  });
+  return keys;
+}
+
+// Runs in the page: the CSS text for the collected rules, in source order
+function serializeCritical(keys) {
+  const wanted = new Set(keys);
+  const prefixes = new Set(keys.flatMap((key) => key.split(".").slice(0, -1).map((_, i, parts) => parts.slice(0, i + 1).join("."))));
+  const keyframes = [];
+
+  function emit(rules, path) {
+    let css = "";
+    Array.from(rules).forEach((rule, i) => {
+      const key = `${path}.${i}`;
+      if (rule instanceof CSSKeyframesRule) {
+        keyframes.push(rule);
+      } else if (wanted.has(key)) {
+        css += rule.cssText;
+      } else if (prefixes.has(key)) {
+        const inner = emit(rule.cssRules, key);
+        if (rule instanceof CSSMediaRule) css += `@media ${rule.media.mediaText}{${inner}}`;
+        else if (rule instanceof CSSSupportsRule) css += `@supports ${rule.conditionText}{${inner}}`;
+      }
+    });
+    return css;
+  }
+
+  let css = "";
+  Array.from(document.styleSheets).forEach((sheet, i) => {
+    if (sheet.href && prefixes.has(String(i))) css += emit(sheet.cssRules, String(i));
+  });
+  for (const rule of keyframes) {
+    if (new RegExp(`\\b${rule.name}\\b`).test(css)) css += rule.cssText;
+  }
+  return css;
+}
+
+async function extract(browser, url) {
+  const page = await browser.newPage();
+  try {
+    await page.send("Network.enable");
+    await page.send("Network.setBlockedURLs", { urls: BLOCKED });
+    const keys = new Set();
+    for (const { name, ...metrics } of VIEWPORTS) {
+      await page.send("Emulation.setDeviceMetricsOverride", metrics);
+      await page.goto(url);
+      await page.evaluate("document.fonts.ready.then(() => true)");
+      for (const key of await page.evaluate(`(${collectCritical})()`)) keys.add(key);
+    }
+    return await page.evaluate(`(${serializeCritical})(${JSON.stringify([...keys])})`);
+  } finally {
+    await page.close();
+  }
+}
+
+function deferStylesheets(html, css) {
+  let inlined = false;
+  return html.replace(STYLESHEET, (tag) => {
+    const href = tag.match(/href=["']([^"']+)["']/)?.[1];
+    if (!href?.startsWith("/")) return tag;
+    const preload = `<link rel="preload" as="style" href="${href}" onload="this.onload=null;this.rel='stylesheet'">`;
+    const fallback = `<noscript><link rel="stylesheet" href="${href}"></noscript>`;
+    const critical = inlined ? "" : `<style data-critical>${css.replace(/<\/style/gi, "<\\/style")}</style>`;
+    inlined = true;
+    return critical + preload + fallback;
+  });
+}
+
+let browser;
+try {
+  browser = await launchChrome();
+} catch (err) {
+  const reason = err.message.split("\n")[0];
+  if (process.env.CI) {
+    console.error(`[critical] Chrome failed to start: ${reason}`);
+    process.exit(1);
+  }
+  console.warn(`[critical] skipped, Chrome is not available: ${reason}`);
+  process.exit(0);
+}
+
+const server = await serveDist();
+const rows = [];
+try {
+  for (const file of (await walk(DIST)).filter((f) => f.endsWith(".html"))) {
+    const html = await readFile(file, "utf8");
+    if (html.includes("<style data-critical>") || !html.match(STYLESHEET)) continue;
+    const route = fileToRoute(file);
+    const css = await extract(browser, server.origin + route);
+    await writeFile(file, deferStylesheets(html, css));
+    rows.push({ route, bytes: Buffer.byteLength(css), gzip: gzipSync(css).length });
+  }
+} finally {
+  await browser.close();
+  await server.close();
+}
+
+const width = Math.max(...rows.map((row) => row.route.length), 5);
+console.log(`[critical] ${"page".padEnd(width)}  ${"inlined".padStart(9)}  ${"gzip".padStart(9)}`);
+for (const row of rows) {
+  console.log(`[critical] ${row.route.padEnd(width)}  ${formatBytes(row.bytes).padStart(9)}  ${formatBytes(row.gzip).padStart(9)}`);
+}
@@ -0,0 +1,75 @@
+// Copies only the brand assets the built site actually uses into dist/assets.
+//
+// The repo's assets/ folder is the full 25 MB brand kit (.ai sources,
+// 1x/2x/3x artboard exports, ...). Instead of shipping all of it, scan the
+// rendered HTML, CSS, JS, XML and manifest in dist/ for /assets/... URLs
+// (including absolute https://brewos.io/assets/... ones in meta tags and
+// JSON-LD) and copy just those files, plus the press-kit downloads matched by
+// scripts/assets-allowlist.json.
+
+import { copyFile, mkdir, readFile, rm, stat } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { dirname, join, relative, sep } from "node:path";
+import { ASSET_URL, DIST, ROOT, TEXT_FILE, formatBytes, walk } from "./lib/dist.mjs";
+
+const SOURCE = join(ROOT, "assets");
+const TARGET = join(DIST, "assets");
+
+function globToRegExp(glob) {
+  const source = glob
+    .split("**/")
+    .map((part) =>
+      part
+        .replace(/[.+^${}()|[\]\\]/g, "\\$&")
+        .replace(/\*/g, "[^/]*")
+        .replace(/\?/g, "[^/]"),
+    )
+    .join("(?:.*/)?");
+  return new RegExp(`^${source}$`);
+}
+
+async function referenced() {
+  const urls = new Set();
+  for (const file of await walk(DIST)) {
+    if (file.startsWith(TARGET + sep) || !TEXT_FILE.test(file)) continue;
+    const text = await readFile(file, "utf8");
+    for (const [url] of text.matchAll(ASSET_URL)) {
+      urls.add(decodeURI(url.split(/[?#]/)[0]).slice("/assets/".length));
+    }
+  }
+  return urls;
+}
+
+async function allowListed() {
+  const globs = JSON.parse(await readFile(join(ROOT, "scripts", "assets-allowlist.json"), "utf8"));
+  const patterns = globs.map(globToRegExp);
+  const files = (await walk(SOURCE)).map((file) => relative(SOURCE, file).split(sep).join("/"));
+  return files.filter((file) => patterns.some((re) => re.test(file)));
+}
+
+const wanted = new Set([...(await referenced()), ...(await allowListed())]);
+const missing = [...wanted].filter((file) => !existsSync(join(SOURCE, file)));
+if (missing.length) {
+  console.error("[assets] referenced but missing from assets/:");
+  for (const file of missing) console.error(`  /assets/${file}`);
+  process.exit(1);
+}
+
+// Whatever Astro copied through the public/assets symlink is replaced
+await rm(TARGET, { recursive: true, force: true });
+
+let copied = 0;
+for (const file of [...wanted].sort()) {
+  const dest = join(TARGET, file);
+  await mkdir(dirname(dest), { recursive: true });
+  await copyFile(join(SOURCE, file), dest);
+  copied += (await stat(dest)).size;
+}
+
+let total = 0;
+for (const file of await walk(SOURCE)) total += (await stat(file)).size;
+
+console.log(
+  `[assets] emitted ${wanted.size} files (${formatBytes(copied)}) ` +
+    `of ${formatBytes(total)} in assets/`,
+);
@@ -0,0 +1,60 @@
+// Content-hashes the brand assets in dist/assets so they can be served with
+// an immutable cache policy, like Astro already does for _assets/.
+//
+// Every /assets/... file referenced from the built output gets a sibling
+// named <name>.<hash>.<ext>; all references in HTML, CSS, JS, the web
+// manifest and JSON-LD are rewritten to it and the mapping is written to
+// dist/assets-manifest.json. The unhashed originals stay in place so
+// existing external links (press, social previews) keep working.
+
+import { createHash } from "node:crypto";
+import { copyFile, readFile, writeFile } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { join, sep } from "node:path";
+import { ASSET_URL, DIST, TEXT_FILE, walk } from "./lib/dist.mjs";
+
+const ASSETS = join(DIST, "assets");
+const MANIFEST = join(DIST, "assets-manifest.json");
+
+function hashedPath(path, data) {
+  const hash = createHash("sha256").update(data).digest("hex").slice(0, 8);
+  const dot = path.lastIndexOf(".");
+  return dot > path.lastIndexOf("/") ? `${path.slice(0, dot)}.${hash}${path.slice(dot)}` : `${path}.${hash}`;
+}
+
+const documents = (await walk(DIST)).filter(
+  (file) => TEXT_FILE.test(file) && !file.startsWith(ASSETS + sep) && file !== MANIFEST,
+);
+
+const contents = new Map();
+const manifest = {};
+for (const file of documents) {
+  const text = await readFile(file, "utf8");
+  contents.set(file, text);
+  for (const [raw] of text.matchAll(ASSET_URL)) {
+    const url = decodeURI(raw.split(/[?#]/)[0]);
+    if (manifest[url] || !existsSync(join(DIST, url))) continue;
+    const data = await readFile(join(DIST, url));
+    manifest[url] = hashedPath(url, data);
+    await copyFile(join(DIST, url), join(DIST, manifest[url]));
+  }
+}
+
+let rewritten = 0;
+for (const [file, text] of contents) {
+  const updated = text.replace(ASSET_URL, (raw) => {
+    const [path, suffix = ""] = raw.split(/(?=[?#])/);
+    const hashed = manifest[decodeURI(path)];
+    return hashed ? encodeURI(hashed) + suffix : raw;
+  });
+  if (updated !== text) {
+    await writeFile(file, updated);
+    rewritten++;
+  }
+}
+
+await writeFile(MANIFEST, JSON.stringify(manifest, null, 2) + "\n");
+console.log(
+  `[fingerprint] hashed ${Object.keys(manifest).length} assets, ` +
+    `rewrote references in ${rewritten} files`,
+);
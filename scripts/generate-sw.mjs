@@ -0,0 +1,248 @@
+// Generates dist/sw.js after `astro build`.
+//
+// The worker precaches the rendered HTML of the core pages people read next
+// to their machine (getting started, FAQ) together with every same-origin
+// stylesheet, script, font and image those pages reference. Each responsive
+// image contributes the one candidate a phone would load: the AVIF <source>
+// (every browser with service workers decodes it) at the width its `sizes`
+// selects on a 412px-wide 2x screen. Other widths and formats are cached at
+// runtime if a browser actually picks them. The cache name is
+// derived from the hash of everything precached, so each build that changes
+// any of it ships a new version. A new worker waits until no tab uses the old
+// one before activating and dropping the old cache, so a page that is still
+// open never loses the assets it was rendered with. That also makes it safe
+// to answer core pages from the cache straight away (stale-while-revalidate):
+// their assets are precached in the same cache version. Other pages go to the
+// network first, fall back to a cached copy when the network fails or stalls,
+// and to the precached offline page when there is none.
+
+import { createHash } from "node:crypto";
+import { readFile, writeFile } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { join } from "node:path";
+import { DIST, attr, extractUrls, formatBytes, largestCandidate, routeToFile } from "./lib/dist.mjs";
+
+const CORE_PAGES = ["/", "/getting-started", "/faq"];
+const OFFLINE_PAGE = "/offline";
+const PRECACHE_PAGES = [...CORE_PAGES, OFFLINE_PAGE];
+// How long a navigation waits on a stalled network before using a cached copy
+const NETWORK_TIMEOUT_MS = 3000;
+// How long a prefetched page answers the next navigation without the network,
+// matching the window browsers reuse their own prefetches for
+const PREFETCH_FRESH_MS = 5 * 60 * 1000;
+const PRECACHE_EXT = /\.(css|js|woff2?|png|jpe?g|webp|avif|svg|ico|webmanifest)$/;
+const SRCSET_ATTR = /\s(?:srcset|imagesrcset)=["'][^"']*["']/g;
+
+// Viewport the image candidates are chosen for
+const VIEWPORT_WIDTH = 412;
+const DEVICE_PIXEL_RATIO = 2;
+
+// Slot width in CSS px that `sizes` gives at VIEWPORT_WIDTH, or null when it
+// uses anything beyond max-/min-width conditions and px/vw lengths
+function slotWidth(sizes) {
+  for (const entry of (sizes ?? "").split(",")) {
+    const match = entry.trim().match(/^(?:\((max|min)-width:\s*(\d+)px\)\s+)?(\d+(?:\.\d+)?)(px|vw)$/);
+    if (!match) return null;
+    const [, kind, bound, value, unit] = match;
+    if (kind === "max" && VIEWPORT_WIDTH > Number(bound)) continue;
+    if (kind === "min" && VIEWPORT_WIDTH < Number(bound)) continue;
+    return unit === "vw" ? (VIEWPORT_WIDTH * Number(value)) / 100 : Number(value);
+  }
+  return null;
+}
+
+// Smallest candidate covering the slot at DEVICE_PIXEL_RATIO; the largest
+// when `sizes` can't be evaluated
+function pickCandidate(srcset, sizes) {
+  const candidates = srcset
+    .split(",")
+    .map((candidate) => {
+      const [url, descriptor = "1x"] = candidate.trim().split(/\s+/);
+      return { url, size: parseFloat(descriptor), width: descriptor.endsWith("w") };
+    })
+    .sort((a, b) => a.size - b.size);
+  if (candidates[0]?.width) {
+    const slot = slotWidth(sizes);
+    if (slot === null) return largestCandidate(srcset);
+    const needed = slot * DEVICE_PIXEL_RATIO;
+    return (candidates.find((c) => c.size >= needed) ?? candidates.at(-1)).url;
+  }
+  return (candidates.find((c) => c.size >= DEVICE_PIXEL_RATIO) ?? candidates.at(-1))?.url ?? null;
+}
+
+// One URL per <picture>/<img>; returns them with the image markup removed
+function imageUrls(html) {
+  const urls = [];
+  const add = (tag) => {
+    const srcset = attr(tag, "srcset");
+    const url = srcset ? pickCandidate(srcset, attr(tag, "sizes")) : attr(tag, "src");
+    if (url) urls.push(url);
+    return "";
+  };
+  const rest = html
+    .replace(/<picture[\s\S]*?<\/picture>/g, (picture) => {
+      const sources = [...picture.matchAll(/<source\s[^>]*>/g)].map(([tag]) => tag);
+      const source = sources.find((tag) => attr(tag, "type") === "image/avif") ?? sources[0];
+      const img = picture.match(/<img\s[^>]*>/)?.[0] ?? "";
+      return add(source && attr(source, "srcset") ? source : img);
+    })
+    .replace(/<img\s[^>]*>/g, add);
+  return { urls, rest };
+}
+
+async function collect() {
+  const hash = createHash("sha256");
+  const assets = new Set(["/site.webmanifest"]);
+  let bytes = 0;
+
+  for (const route of PRECACHE_PAGES) {
+    const html = await readFile(routeToFile(route), "utf8");
+    hash.update(html);
+    bytes += Buffer.byteLength(html);
+    // Image preloads (imagesrcset) repeat a <picture> already counted
+    const { urls, rest } = imageUrls(html);
+    for (const url of [...urls, ...extractUrls(rest.replace(SRCSET_ATTR, ""))]) {
+      if (url.startsWith("/") && PRECACHE_EXT.test(url)) assets.add(url);
+    }
+  }
+
+  // Stylesheets can pull in fonts and images of their own
+  for (const url of [...assets]) {
+    if (!url.endsWith(".css")) continue;
+    for (const ref of extractUrls(await readFile(join(DIST, url), "utf8"))) {
+      if (PRECACHE_EXT.test(ref)) assets.add(ref);
+    }
+  }
+
+  const present = [];
+  for (const url of [...assets].sort()) {
+    const file = join(DIST, decodeURI(url));
+    if (!existsSync(file)) {
+      console.warn(`[sw] skipping ${url}: not in dist/`);
+      continue;
+    }
+    const data = await readFile(file);
+    hash.update(url).update(data);
+    bytes += data.length;
+    present.push(url);
+  }
+
+  return { version: hash.digest("hex").slice(0, 12), assets: present, bytes };
+}
+
+function worker({ version, assets }) {
+  return `// Generated by scripts/generate-sw.mjs. Do not edit.
+const VERSION = ${JSON.stringify(version)};
+const CACHE = "brewos-" + VERSION;
+const PAGES = ${JSON.stringify(PRECACHE_PAGES)};
+const CORE_PAGES = ${JSON.stringify(CORE_PAGES)};
+const NETWORK_TIMEOUT_MS = ${NETWORK_TIMEOUT_MS};
+const PREFETCH_FRESH_MS = ${PREFETCH_FRESH_MS};
+const PREFETCHED_AT = "x-brewos-prefetched-at";
+const OFFLINE = ${JSON.stringify(OFFLINE_PAGE)};
+const ASSETS = ${JSON.stringify(assets)};
+
+// "/faq/", "/faq/index.html" and "/faq" are the same page
+function pageKey(url) {
+  const path = url.pathname.replace(/index\\.html$/, "").replace(/\\/$/, "");
+  return path || "/";
+}
+
+// Cache a clean copy: redirected responses can't answer navigations.
+// Prefetched copies are stamped so the navigation that follows can use them.
+async function putPage(cache, key, response, prefetched = false) {
+  const body = await response.blob();
+  const headers = new Headers(response.headers);
+  if (prefetched) headers.set(PREFETCHED_AT, String(Date.now()));
+  await cache.put(key, new Response(body, { status: response.status, headers }));
+}
+
+self.addEventListener("install", (event) => {
+  event.waitUntil((async () => {
+    const cache = await caches.open(CACHE);
+    await cache.addAll(ASSETS);
+    await Promise.all(PAGES.map(async (page) => {
+      const response = await fetch(page === "/" ? "/" : page + "/", { cache: "reload" });
+      if (response.ok) await putPage(cache, page, response);
+    }));
+  })());
+});
+
+self.addEventListener("activate", (event) => {
+  event.waitUntil((async () => {
+    for (const key of await caches.keys()) {
+      if (key.startsWith("brewos-") && key !== CACHE) await caches.delete(key);
+    }
+    await self.clients.claim();
+  })());
+});
+
+self.addEventListener("fetch", (event) => {
+  const { request } = event;
+  const url = new URL(request.url);
+  if (request.method !== "GET" || url.origin !== self.location.origin) return;
+
+  if (request.mode === "navigate") {
+    const key = pageKey(url);
+    event.respondWith((async () => {
+      const cache = await caches.open(CACHE);
+      const cached = await cache.match(key);
+      const network = fetch(request);
+      event.waitUntil(network.then(async (response) => {
+        if (response.ok) await putPage(cache, key, response.clone());
+      }).catch(() => {}));
+
+      // Core pages render entirely from this cache version, and a page
+      // prefetched moments ago is as fresh as the network: answer at once
+      if (cached && CORE_PAGES.includes(key)) return cached;
+      if (cached && Date.now() - Number(cached.headers.get(PREFETCHED_AT)) < PREFETCH_FRESH_MS) return cached;
+
+      try {
+        if (!cached) return await network;
+        const stalled = new Promise((_, reject) => setTimeout(reject, NETWORK_TIMEOUT_MS));
+        return await Promise.race([network, stalled]);
+      } catch {
+        return cached || (await cache.match(OFFLINE)) || Response.error();
+      }
+    })());
+    return;
+  }
+
+  // Page prefetches (see src/components/Prefetch.astro) go to the network
+  // and land in the page cache, so the navigation that follows within
+  // PREFETCH_FRESH_MS is instant and the page is also available offline
+  if (!/\\.[a-z0-9]+$/i.test(url.pathname)) {
+    const key = pageKey(url);
+    event.respondWith((async () => {
+      const cache = await caches.open(CACHE);
+      const response = await fetch(request);
+      if (response.ok && response.type === "basic") {
+        event.waitUntil(putPage(cache, key, response.clone(), true));
+      }
+      return response;
+    })());
+    return;
+  }
+
+  // Static files: cache first. The whole cache is replaced whenever a
+  // precached file changes, so a new build never serves stale assets.
+  event.respondWith((async () => {
+    const cache = await caches.open(CACHE);
+    const cached = await cache.match(request, { ignoreSearch: true });
+    if (cached) return cached;
+    const response = await fetch(request);
+    if (response.ok && response.type === "basic") {
+      event.waitUntil(cache.put(request, response.clone()));
+    }
+    return response;
+  })());
+});
+`;
+}
+
+const result = await collect();
+await writeFile(join(DIST, "sw.js"), worker(result));
+console.log(
+  `[sw] precaching ${PRECACHE_PAGES.length} pages + ${result.assets.length} assets ` +
+    `(${formatBytes(result.bytes)}), version ${result.version}`,
+);
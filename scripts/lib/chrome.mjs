@@ -0,0 +1,180 @@
+// Minimal headless Chrome driver over the DevTools protocol.
+//
+// Talks CDP through --remote-debugging-pipe (fd 3 in, fd 4 out, messages
+// separated by NUL bytes), so scripts can drive a real browser without
+// adding puppeteer/playwright to the dependency tree. Chrome is taken from
+// $CHROME_PATH or the usual binary names on PATH.
+
+import { spawn, spawnSync } from "node:child_process";
+import { mkdtempSync, rmSync } from "node:fs";
+import { tmpdir } from "node:os";
+import { join } from "node:path";
+
+const CANDIDATES = [
+  "google-chrome-stable",
+  "google-chrome",
+  "chromium",
+  "chromium-browser",
+  "/Applications/Google Chrome.app/Contents/MacOS/Google Chrome",
+  "/Applications/Chromium.app/Contents/MacOS/Chromium",
+];
+
+export function findChrome() {
+  if (process.env.CHROME_PATH) return process.env.CHROME_PATH;
+  for (const candidate of CANDIDATES) {
+    if (spawnSync(candidate, ["--version"], { stdio: "ignore" }).status === 0) return candidate;
+  }
+  throw new Error("Chrome/Chromium not found; set CHROME_PATH to a Chrome binary");
+}
+
+class Connection {
+  #nextId = 1;
+  #pending = new Map();
+  #listeners = new Set();
+  #buffer = "";
+
+  constructor(input, output) {
+    this.input = input;
+    output.setEncoding("utf8");
+    output.on("data", (chunk) => {
+      const parts = (this.#buffer + chunk).split("\0");
+      this.#buffer = parts.pop();
+      for (const part of parts) this.#dispatch(JSON.parse(part));
+    });
+  }
+
+  #dispatch(message) {
+    if (message.id !== undefined) {
+      const pending = this.#pending.get(message.id);
+      if (!pending) return;
+      this.#pending.delete(message.id);
+      if (message.error) {
+        pending.reject(new Error(`${pending.method}: ${message.error.message}`));
+      } else {
+        pending.resolve(message.result);
+      }
+      return;
+    }
+    for (const listener of this.#listeners) listener(message);
+  }
+
+  send(method, params = {}, sessionId) {
+    const id = this.#nextId++;
+    this.input.write(JSON.stringify({ id, method, params, sessionId }) + "\0");
+    return new Promise((resolve, reject) => this.#pending.set(id, { resolve, reject, method }));
+  }
+
+  listen(listener) {
+    this.#listeners.add(listener);
+    return () => this.#listeners.delete(listener);
+  }
+}
+
+/** A page in its own browser context (fresh cache, cookies and storage). */
+class Page {
+  constructor(connection, contextId, targetId, sessionId) {
+    this.connection = connection;
+    this.contextId = contextId;
+    this.targetId = targetId;
+    this.sessionId = sessionId;
+  }
+
+  send(method, params) {
+    return this.connection.send(method, params, this.sessionId);
+  }
+
+  on(method, handler) {
+    return this.connection.listen((message) => {
+      if (message.sessionId === this.sessionId && message.method === method) handler(message.params);
+    });
+  }
+
+  waitFor(method, timeout = 30000) {
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        off();
+        reject(new Error(`timed out waiting for ${method}`));
+      }, timeout);
+      const off = this.on(method, (params) => {
+        clearTimeout(timer);
+        off();
+        resolve(params);
+      });
+    });
+  }
+
+  async evaluate(expression) {
+    const { result, exceptionDetails } = await this.send("Runtime.evaluate", {
+      expression,
+      awaitPromise: true,
+      returnByValue: true,
+    });
+    if (exceptionDetails) throw new Error(exceptionDetails.exception?.description ?? exceptionDetails.text);
+    return result.value;
+  }
+
+  async goto(url, { timeout = 60000 } = {}) {
+    const loaded = this.waitFor("Page.loadEventFired", timeout);
+    await this.send("Page.navigate", { url });
+    await loaded;
+  }
+
+  async close() {
+    await this.connection.send("Target.disposeBrowserContext", { browserContextId: this.contextId });
+  }
+}
+
+export async function launchChrome({ args = [] } = {}) {
+  const profile = mkdtempSync(join(tmpdir(), "brewos-chrome-"));
+  const flags = [
+    "--headless=new",
+    "--remote-debugging-pipe",
+    `--user-data-dir=${profile}`,
+    "--no-first-run",
+    "--no-default-browser-check",
+    "--disable-extensions",
+    "--disable-background-networking",
+    "--disable-component-update",
+    "--disable-sync",
+    "--mute-audio",
+    ...(process.getuid?.() === 0 ? ["--no-sandbox"] : []),
+    ...args,
+  ];
+  const child = spawn(findChrome(), flags, { stdio: ["ignore", "ignore", "pipe", "pipe", "pipe"] });
+  let stderr = "";
+  child.stderr.on("data", (chunk) => (stderr += chunk));
+  for (const stream of [child.stdio[3], child.stdio[4]]) stream.on("error", () => {});
+
+  const connection = new Connection(child.stdio[3], child.stdio[4]);
+  const exited = new Promise((resolve) => child.once("exit", resolve));
+  const crashed = new Promise((_, reject) => {
+    child.once("error", reject);
+    child.once("close", (code) => reject(new Error(`Chrome exited with code ${code}\n${stderr.trim()}`)));
+  });
+
+  try {
+    await Promise.race([connection.send("Browser.getVersion"), crashed]);
+  } catch (err) {
+    rmSync(profile, { recursive: true, force: true });
+    throw err;
+  }
+  crashed.catch(() => {});
+
+  return {
+    async newPage() {
+      const { browserContextId } = await connection.send("Target.createBrowserContext", { disposeOnDetach: true });
+      const { targetId } = await connection.send("Target.createTarget", { url: "about:blank", browserContextId });
+      const { sessionId } = await connection.send("Target.attachToTarget", { targetId, flatten: true });
+      const page = new Page(connection, browserContextId, targetId, sessionId);
+      await page.send("Page.enable");
+      await page.send("Runtime.enable");
+      return page;
+    },
+    async close() {
+      connection.send("Browser.close").catch(() => {});
+      await Promise.race([exited, new Promise((resolve) => setTimeout(resolve, 5000))]);
+      child.kill();
+      rmSync(profile, { recursive: true, force: true });
+    },
+  };
+}
@@ -0,0 +1,93 @@
+// Helpers shared by the post-build scripts that operate on dist/.
+
+import { readdir } from "node:fs/promises";
+import { dirname, join, relative, sep } from "node:path";
+import { fileURLToPath } from "node:url";
+
+export const ROOT = join(dirname(fileURLToPath(import.meta.url)), "..", "..");
+export const DIST = join(ROOT, "dist");
+
+/** Recursively list every file below `dir` (absolute paths). */
+export async function walk(dir) {
+  const out = [];
+  for (const entry of await readdir(dir, { withFileTypes: true })) {
+    const path = join(dir, entry.name);
+    if (entry.isDirectory()) {
+      out.push(...(await walk(path)));
+    } else {
+      out.push(path);
+    }
+  }
+  return out;
+}
+
+/** Site-absolute URL path ("/faq/index.html") for a file in dist/. */
+export function toUrlPath(file) {
+  return "/" + relative(DIST, file).split(sep).join("/");
+}
+
+/** dist/ file holding the rendered HTML for a route ("/faq" -> dist/faq/index.html). */
+export function routeToFile(route) {
+  const clean = route.replace(/^\/+|\/+$/g, "");
+  return join(DIST, clean, "index.html");
+}
+
+/** Route ("/faq") for a rendered HTML file in dist/. */
+export function fileToRoute(file) {
+  const path = toUrlPath(file).replace(/index\.html$/, "").replace(/\.html$/, "");
+  return path.length > 1 ? path.replace(/\/$/, "") : "/";
+}
+
+/** Value of attribute `name` on an HTML start tag, or null. */
+export function attr(tag, name) {
+  return tag.match(new RegExp(`\\s${name}=["']([^"']*)["']`))?.[1] ?? null;
+}
+
+/** Widest (or highest density) candidate of a srcset. */
+export function largestCandidate(srcset) {
+  let best = null;
+  for (const candidate of srcset.split(",")) {
+    const [url, descriptor = "1x"] = candidate.trim().split(/\s+/);
+    const size = parseFloat(descriptor);
+    if (!best || size > best.size) best = { url, size };
+  }
+  return best?.url ?? null;
+}
+
+const ATTR_URL = /\s(?:src|href|poster|content)=["']([^"']+)["']/g;
+const ATTR_SRCSET = /\s(?:srcset|imagesrcset)=["']([^"']+)["']/g;
+const CSS_URL = /url\(\s*["']?([^"')]+)["']?\s*\)/g;
+
+/**
+ * Every same-origin URL path referenced from an HTML or CSS document:
+ * src/href attributes, srcset candidates and CSS url()s. Query strings and
+ * fragments are dropped; external and data: URLs are skipped.
+ */
+export function extractUrls(text, site = "https://brewos.io") {
+  const found = new Set();
+  const add = (raw) => {
+    let url = raw.trim();
+    if (url.startsWith(site)) url = url.slice(site.length);
+    if (!url.startsWith("/") || url.startsWith("//")) return;
+    found.add(url.split(/[?#]/)[0]);
+  };
+  for (const [, url] of text.matchAll(ATTR_URL)) add(url);
+  for (const [, set] of text.matchAll(ATTR_SRCSET)) {
+    for (const candidate of set.split(",")) add(candidate.trim().split(/\s+/)[0]);
+  }
+  for (const [, url] of text.matchAll(CSS_URL)) add(url);
+  return found;
+}
+
+// /assets/... brand-asset URLs anywhere in a text file: attributes, CSS,
+// JSON-LD and the web manifest, relative or absolute
+export const ASSET_URL = /\/assets\/[^"'\s)<>,\\]+/g;
+
+/** Text files in dist/ that can reference other files. */
+export const TEXT_FILE = /\.(html|css|js|mjs|xml|json|webmanifest|txt)$/;
+
+export function formatBytes(bytes) {
+  if (Math.abs(bytes) < 1024) return `${bytes} B`;
+  if (Math.abs(bytes) < 1024 * 1024) return `${(bytes / 1024).toFixed(1)} KB`;
+  return `${(bytes / 1024 / 1024).toFixed(2)} MB`;
+}
@@ -0,0 +1,88 @@
+// Tiny static file server for dist/, used by the scripts that load built
+// pages in a browser. Like a production host it serves the precompressed
+// .br/.gz siblings written by scripts/compress.mjs when the client accepts
+// them, so measured transfer sizes match what visitors download.
+
+import { createServer } from "node:http";
+import { readFile, stat } from "node:fs/promises";
+import { extname, join, normalize } from "node:path";
+import { DIST } from "./dist.mjs";
+
+const TYPES = {
+  ".html": "text/html; charset=utf-8",
+  ".css": "text/css; charset=utf-8",
+  ".js": "text/javascript; charset=utf-8",
+  ".mjs": "text/javascript; charset=utf-8",
+  ".json": "application/json",
+  ".webmanifest": "application/manifest+json",
+  ".xml": "application/xml",
+  ".txt": "text/plain; charset=utf-8",
+  ".svg": "image/svg+xml",
+  ".png": "image/png",
+  ".jpg": "image/jpeg",
+  ".jpeg": "image/jpeg",
+  ".webp": "image/webp",
+  ".avif": "image/avif",
+  ".ico": "image/x-icon",
+  ".woff2": "font/woff2",
+  ".woff": "font/woff",
+};
+
+const ENCODINGS = [
+  ["br", ".br"],
+  ["gzip", ".gz"],
+];
+
+async function isFile(path) {
+  try {
+    return (await stat(path)).isFile();
+  } catch {
+    return false;
+  }
+}
+
+async function resolve(pathname) {
+  const path = normalize(join(DIST, decodeURIComponent(pathname)));
+  if (!path.startsWith(DIST)) return null;
+  for (const candidate of [path, join(path, "index.html"), `${path}.html`]) {
+    if (await isFile(candidate)) return candidate;
+  }
+  return null;
+}
+
+/** Start serving dist/ on a free port; resolves to { origin, close() }. */
+export function serveDist({ port = 0 } = {}) {
+  const server = createServer(async (req, res) => {
+    const { pathname } = new URL(req.url, "http://localhost");
+    const file = await resolve(pathname);
+    if (!file) {
+      res.writeHead(404, { "Content-Type": "text/plain" }).end("Not found");
+      return;
+    }
+
+    const headers = { "Content-Type": TYPES[extname(file)] ?? "application/octet-stream" };
+    let body = null;
+    const accepted = req.headers["accept-encoding"] ?? "";
+    for (const [encoding, suffix] of ENCODINGS) {
+      if (accepted.includes(encoding) && (await isFile(file + suffix))) {
+        body = await readFile(file + suffix);
+        headers["Content-Encoding"] = encoding;
+        headers["Vary"] = "Accept-Encoding";
+        break;
+      }
+    }
+    body ??= await readFile(file);
+    headers["Content-Length"] = body.length;
+    res.writeHead(200, headers).end(req.method === "HEAD" ? undefined : body);
+  });
+
+  return new Promise((resolvePromise) => {
+    server.listen(port, "127.0.0.1", () => {
+      const { port: actual } = server.address();
+      resolvePromise({
+        origin: `http://127.0.0.1:${actual}`,
+        close: () => new Promise((done) => server.close(done)),
+      });
+    });
+  });
+}
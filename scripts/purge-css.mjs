@@ -0,0 +1,191 @@
+// Removes CSS rules that no built page can match, then re-hashes the
+// stylesheets it changed.
+//
+// Like PurgeCSS, it works on tokens rather than a DOM: every class, id, tag
+// and attribute name a selector requires must appear somewhere in the
+// built HTML or JS (inline scripts included, which covers most classes
+// toggled from JavaScript). Anything built at runtime without appearing
+// literally goes in SAFELIST. Selector parts inside functional
+// pseudo-classes (:is(), :not(), :has(), ...) are never required, and
+// @keyframes are dropped once no remaining rule in any stylesheet animates
+// with them.
+//
+// Purged files under /_assets/ get a new content hash in their name, since
+// those URLs are served as immutable. Runs before critical-css.mjs.
+
+import { createHash } from "node:crypto";
+import { readFile, rename, writeFile } from "node:fs/promises";
+import postcss from "postcss";
+import { DIST, TEXT_FILE, formatBytes, toUrlPath, walk } from "./lib/dist.mjs";
+
+// Class and attribute names that only ever exist at runtime
+const SAFELIST = {
+  classes: ["scrolled", "active"],
+  attributes: ["open", "data-effects", "data-motion"],
+};
+
+const FUNCTIONAL_PSEUDO = /:{1,2}[a-z-]+\([^()]*\)/g;
+const SIMPLE = /([.#]?)(-?[_a-zA-Z][\w-]*)|\[\s*([\w-]+)[^\]]*\]/g;
+
+// Page content that is text, not markup: the CSS being purged (which would
+// otherwise keep every inline rule alive by naming its own selectors) and
+// JSON-LD
+const NOT_MARKUP = /<style\b[^>]*>[\s\S]*?<\/style>|<script type="application\/ld\+json"[^>]*>[\s\S]*?<\/script>/g;
+
+/** Every identifier-like token in the built pages and scripts. */
+function collectTokens(texts) {
+  const tokens = new Set([...SAFELIST.classes, ...SAFELIST.attributes]);
+  for (const text of texts) {
+    for (const [token] of text.replace(NOT_MARKUP, "").matchAll(/[\w-]+/g)) tokens.add(token);
+  }
+  return tokens;
+}
+
+/** Whether every class, id, tag and attribute `selector` needs is in `tokens`. */
+function mayMatch(selector, tokens) {
+  // Drop strings and functional pseudo-classes (nested ones from the inside out)
+  let bare = selector.replace(/(["'])(?:\\.|(?!\1).)*\1/g, "");
+  while (FUNCTIONAL_PSEUDO.test(bare)) bare = bare.replace(FUNCTIONAL_PSEUDO, "");
+  // Plain pseudo-classes/elements (:hover, ::before) aren't in the markup
+  bare = bare.replace(/:{1,2}[a-z-]+/gi, "");
+
+  for (const [, prefix, name, attribute] of bare.matchAll(SIMPLE)) {
+    const token = attribute ?? name;
+    if (!prefix && !attribute && /^(html|body|\*)$/.test(token)) continue;
+    if (!tokens.has(token)) return false;
+  }
+  return true;
+}
+
+/** Drops the selectors of `root` no page can match, and rules left without any. */
+function purgeRules(root, tokens) {
+  root.walkRules((rule) => {
+    if (rule.parent?.type === "atrule" && /keyframes$/i.test(rule.parent.name)) return;
+    const kept = rule.selectors.filter((selector) => mayMatch(selector, tokens));
+    if (kept.length === 0) rule.remove();
+    else if (kept.length < rule.selectors.length) rule.selectors = kept;
+  });
+}
+
+/** Adds every word of `root`'s animation declarations to `names`. */
+function collectAnimations(root, names) {
+  root.walkDecls(/^(-webkit-)?animation(-name)?$/i, (decl) => {
+    for (const [word] of decl.value.matchAll(/[\w-]+/g)) names.add(word);
+  });
+}
+
+/** Removes keyframes not in `animations`, then grouping rules left empty. */
+function prune(root, animations) {
+  root.walkAtRules(/keyframes$/i, (atRule) => {
+    if (!animations.has(atRule.params.trim())) atRule.remove();
+  });
+
+  let emptied = true;
+  while (emptied) {
+    emptied = false;
+    root.walkAtRules((atRule) => {
+      if (atRule.nodes && atRule.nodes.length === 0) {
+        atRule.remove();
+        emptied = true;
+      }
+    });
+  }
+}
+
+const files = await walk(DIST);
+const documents = files.filter((file) => /\.(html|m?js)$/.test(file));
+const texts = await Promise.all(documents.map((file) => readFile(file, "utf8")));
+const tokens = collectTokens(texts);
+
+// Stylesheets and the <style> blocks Astro inlined into the pages. Keyframes
+// are often defined in one (global.css) and used from another (a page's own
+// chunk), so unused ones are only pruned once every sheet has been purged.
+const STYLE_BLOCK = /(<style\b[^>]*>)([\s\S]*?)(<\/style>)/g;
+const sheets = [];
+for (const file of files.filter((f) => f.endsWith(".css"))) {
+  sheets.push({ file, css: await readFile(file, "utf8") });
+}
+for (const [i, file] of documents.entries()) {
+  if (!file.endsWith(".html")) continue;
+  for (const [, , css] of texts[i].matchAll(STYLE_BLOCK)) sheets.push({ file, css, inline: true });
+}
+
+const animations = new Set();
+for (const sheet of sheets) {
+  sheet.root = postcss.parse(sheet.css);
+  purgeRules(sheet.root, tokens);
+  collectAnimations(sheet.root, animations);
+}
+const keyframes = (roots) => {
+  const names = new Set();
+  for (const root of roots) root.walkAtRules(/keyframes$/i, (atRule) => names.add(atRule.params.trim()));
+  return names;
+};
+const defined = keyframes(sheets.map((sheet) => sheet.root));
+for (const sheet of sheets) {
+  prune(sheet.root, animations);
+  sheet.purged = sheet.root.toString();
+}
+
+// Every animation a surviving rule names must still have its keyframes
+const kept = keyframes(sheets.map((sheet) => sheet.root));
+const lost = [...animations].filter((name) => defined.has(name) && !kept.has(name));
+if (lost.length) {
+  console.error(`[purge] keyframes still in use were removed: ${lost.join(", ")}`);
+  process.exit(1);
+}
+
+const rows = [];
+const renames = new Map();
+
+for (const { file, css, purged, inline } of sheets) {
+  if (inline || purged === css) continue;
+  rows.push({ name: toUrlPath(file), before: Buffer.byteLength(css), after: Buffer.byteLength(purged) });
+
+  await writeFile(file, purged);
+  const url = toUrlPath(file);
+  if (url.startsWith("/_assets/")) {
+    const hash = createHash("sha256").update(purged).digest("hex").slice(0, 8);
+    const hashed = url.replace(/(\.[\w-]{6,})?\.css$/, `.${hash}.css`);
+    await rename(file, DIST + hashed);
+    renames.set(url, hashed);
+  }
+}
+
+for (const [i, file] of documents.entries()) {
+  const blocks = sheets.filter((sheet) => sheet.inline && sheet.file === file);
+  if (blocks.length === 0) continue;
+  let before = 0;
+  let after = 0;
+  let next = 0;
+  const html = texts[i].replace(STYLE_BLOCK, (block, open, css, close) => {
+    const { purged } = blocks[next++];
+    before += Buffer.byteLength(css);
+    after += Buffer.byteLength(purged);
+    return open + purged + close;
+  });
+  if (after < before) {
+    await writeFile(file, html);
+    rows.push({ name: `${toUrlPath(file)} <style>`, before, after });
+  }
+}
+
+if (renames.size) {
+  for (const file of (await walk(DIST)).filter((f) => TEXT_FILE.test(f))) {
+    const text = await readFile(file, "utf8");
+    let updated = text;
+    for (const [from, to] of renames) updated = updated.replaceAll(from, to);
+    if (updated !== text) await writeFile(file, updated);
+  }
+}
+
+const width = Math.max(...rows.map((row) => row.name.length), 4);
+let saved = 0;
+for (const row of rows) {
+  saved += row.before - row.after;
+  const pct = ((1 - row.after / row.before) * 100).toFixed(1);
+  console.log(
+    `[purge] ${row.name.padEnd(width)}  ${formatBytes(row.before).padStart(9)} -> ${formatBytes(row.after).padStart(9)}  (-${pct}%)`,
+  );
+}
+console.log(`[purge] removed ${formatBytes(saved)} of unused CSS from ${rows.length} stylesheets`);
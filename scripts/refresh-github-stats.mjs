@@ -0,0 +1,43 @@
+// Updates src/data/github-stats.json, the committed fallback src/lib/github.ts
+// renders when a build can't reach the GitHub API. Run it by hand and commit
+// the result; builds only ever read the file.
+//
+//   npm run refresh-github-stats
+//
+// Set GITHUB_TOKEN to avoid the unauthenticated rate limit.
+
+import { readFile, writeFile } from "node:fs/promises";
+import { join } from "node:path";
+import { ROOT } from "./lib/dist.mjs";
+
+const FILE = join(ROOT, "src", "data", "github-stats.json");
+
+async function request(path) {
+  const headers = { Accept: "application/vnd.github+json", "User-Agent": "brewos-site-build" };
+  if (process.env.GITHUB_TOKEN) headers.Authorization = `Bearer ${process.env.GITHUB_TOKEN}`;
+  return fetch(`https://api.github.com${path}`, { headers, signal: AbortSignal.timeout(10000) });
+}
+
+const { repo } = JSON.parse(await readFile(FILE, "utf8"));
+
+const repoRes = await request(`/repos/${repo}`);
+if (!repoRes.ok) {
+  console.error(`[github-stats] GitHub API responded ${repoRes.status} for ${repo}`);
+  process.exit(1);
+}
+const data = await repoRes.json();
+
+// A repo without releases answers 404 here; that is not an error
+const releaseRes = await request(`/repos/${repo}/releases/latest`);
+const release = releaseRes.ok ? await releaseRes.json() : null;
+
+const stats = {
+  repo,
+  stars: data.stargazers_count ?? null,
+  forks: data.forks_count ?? null,
+  openIssues: data.open_issues_count ?? null,
+  latestRelease: release?.tag_name ?? null,
+  fetchedAt: new Date().toISOString(),
+};
+await writeFile(FILE, JSON.stringify(stats, null, 2) + "\n");
+console.log(`[github-stats] ${repo}: ${stats.stars} stars, latest release ${stats.latestRelease ?? "none"}`);
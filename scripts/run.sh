@@ -1,6 +1,6 @@
 #!/bin/bash
 # Run BrewOS Marketing Site in development mode
-# Usage: ./scripts/run.sh [--build|--preview]
+# Usage: ./scripts/run.sh [--build|--preview|--bench [bench options]]
 
 set -e
 
@@ -28,6 +28,12 @@ elif [ "$1" == "--preview" ]; then
     echo ""
     echo "🌐 Starting preview server..."
     npm run preview
+elif [ "$1" == "--bench" ]; then
+    echo "🔨 Building site for benchmarking..."
+    npm run build
+    echo ""
+    echo "⏱️  Benchmarking pages in headless Chrome..."
+    node scripts/bench.mjs "${@:2}"
 else
     echo "🌐 Starting Astro dev server..."
     echo "   Site will be available at http://localhost:4321"
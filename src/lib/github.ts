@@ -0,0 +1,112 @@
+// Build-time GitHub repository stats.
+//
+// Pages are static, so the numbers are fetched once per build and baked into
+// the HTML. Responses are cached on disk for CACHE_TTL_MS so repeated local
+// builds don't hit the API, and src/data/github-stats.json is the committed
+// fallback used when there is no network and no cache; update it with
+// `npm run refresh-github-stats` (the build itself never writes to src/).
+
+import { mkdir, readFile, writeFile } from 'node:fs/promises';
+import { dirname, join } from 'node:path';
+import fallback from '../data/github-stats.json';
+
+export interface GitHubStats {
+  repo: string;
+  stars: number | null;
+  forks: number | null;
+  openIssues: number | null;
+  latestRelease: string | null;
+  fetchedAt: string | null;
+}
+
+const CACHE_DIR = join(process.cwd(), 'node_modules', '.cache', 'brewos');
+const CACHE_TTL_MS = Number(process.env.GITHUB_STATS_TTL_MS ?? 6 * 60 * 60 * 1000);
+const REQUEST_TIMEOUT_MS = 5000;
+
+const pending = new Map<string, Promise<GitHubStats>>();
+
+function cachePath(repo: string): string {
+  return join(CACHE_DIR, `github-stats-${repo.replace('/', '__')}.json`);
+}
+
+async function readCache(repo: string): Promise<GitHubStats | null> {
+  try {
+    return JSON.parse(await readFile(cachePath(repo), 'utf8'));
+  } catch {
+    return null;
+  }
+}
+
+async function writeCache(stats: GitHubStats): Promise<void> {
+  const file = cachePath(stats.repo);
+  await mkdir(dirname(file), { recursive: true });
+  await writeFile(file, JSON.stringify(stats, null, 2) + '\n');
+}
+
+async function request(path: string): Promise<Response> {
+  const headers: Record<string, string> = {
+    Accept: 'application/vnd.github+json',
+    'User-Agent': 'brewos-site-build',
+  };
+  if (process.env.GITHUB_TOKEN) {
+    headers.Authorization = `Bearer ${process.env.GITHUB_TOKEN}`;
+  }
+  return fetch(`https://api.github.com${path}`, {
+    headers,
+    signal: AbortSignal.timeout(REQUEST_TIMEOUT_MS),
+  });
+}
+
+async function fetchStats(repo: string): Promise<GitHubStats> {
+  const repoRes = await request(`/repos/${repo}`);
+  if (!repoRes.ok) {
+    throw new Error(`GitHub API responded ${repoRes.status} for ${repo}`);
+  }
+  const data = await repoRes.json();
+
+  // A repo without releases answers 404 here; that is not an error
+  const releaseRes = await request(`/repos/${repo}/releases/latest`);
+  const release = releaseRes.ok ? await releaseRes.json() : null;
+
+  return {
+    repo,
+    stars: data.stargazers_count ?? null,
+    forks: data.forks_count ?? null,
+    openIssues: data.open_issues_count ?? null,
+    latestRelease: release?.tag_name ?? null,
+    fetchedAt: new Date().toISOString(),
+  };
+}
+
+async function loadStats(repo: string): Promise<GitHubStats> {
+  const cached = await readCache(repo);
+  const age = cached?.fetchedAt ? Date.now() - Date.parse(cached.fetchedAt) : Infinity;
+  if (cached && age < CACHE_TTL_MS) {
+    return cached;
+  }
+
+  try {
+    const stats = await fetchStats(repo);
+    await writeCache(stats);
+    return stats;
+  } catch (err) {
+    console.warn(`[github-stats] ${(err as Error).message}; using ${cached ? 'stale cache' : 'committed fallback'}`);
+    if (cached) return cached;
+    return { ...(fallback as GitHubStats), repo };
+  }
+}
+
+/** Stats for `owner/name`, fetched at most once per build. */
+export function getGitHubStats(repo: string): Promise<GitHubStats> {
+  let stats = pending.get(repo);
+  if (!stats) {
+    stats = loadStats(repo);
+    pending.set(repo, stats);
+  }
+  return stats;
+}
+
+/** Compact star count for display, e.g. 1234 -> "1.2k". */
+export function formatCount(count: number): string {
+  return count >= 1000 ? `${(count / 1000).toFixed(1)}k` : String(count);
+}
@@ -0,0 +1,66 @@
+// Icon registry for the shared SVG sprite.
+//
+// Every icon is emitted once as a <symbol> in /icons-<hash>.svg (see
+// src/pages/[sprite].svg.ts) and referenced from pages with <use> through
+// the Icon component, so the path data is downloaded and cached once instead
+// of being repeated in every HTML document.
+
+import { createHash } from 'node:crypto';
+
+interface IconDef {
+  viewBox?: string;
+  // 'stroke' icons are outlined (Feather style), 'fill' icons are solid
+  style: 'stroke' | 'fill';
+  body: string;
+}
+
+const GITHUB_MARK = '<path d="M12 0c-6.626 0-12 5.373-12 12 0 5.302 3.438 9.8 8.207 11.387.599.111.793-.261.793-.577v-2.234c-3.338.726-4.033-1.416-4.033-1.416-.546-1.387-1.333-1.756-1.333-1.756-1.089-.745.083-.729.083-.729 1.205.084 1.839 1.237 1.839 1.237 1.07 1.834 2.807 1.304 3.492.997.107-.775.418-1.305.762-1.604-2.665-.305-5.467-1.334-5.467-5.931 0-1.311.469-2.381 1.236-3.221-.124-.303-.535-1.524.117-3.176 0 0 1.008-.322 3.301 1.23.957-.266 1.983-.399 3.003-.404 1.02.005 2.047.138 3.006.404 2.291-1.552 3.297-1.23 3.297-1.23.653 1.653.242 2.874.118 3.176.77.84 1.235 1.911 1.235 3.221 0 4.609-2.807 5.624-5.479 5.921.43.372.823 1.102.823 2.222v3.293c0 .319.192.694.801.576 4.765-1.589 8.199-6.086 8.199-11.386 0-6.627-5.373-12-12-12z"/>';
+
+export const icons = {
+  github: { style: 'fill', body: GITHUB_MARK },
+
+  // Navigation
+  home: { style: 'stroke', body: '<path d="M3 9l9-7 9 7v11a2 2 0 0 1-2 2H5a2 2 0 0 1-2-2z"/><polyline points="9 22 9 12 15 12 15 22"/>' },
+  document: { style: 'stroke', body: '<path d="M14 2H6a2 2 0 0 0-2 2v16a2 2 0 0 0 2 2h12a2 2 0 0 0 2-2V8z"/><polyline points="14 2 14 8 20 8"/><line x1="16" y1="13" x2="8" y2="13"/><line x1="16" y1="17" x2="8" y2="17"/><polyline points="10 9 9 9 8 9"/>' },
+  help: { style: 'stroke', body: '<circle cx="12" cy="12" r="10"/><path d="M9.09 9a3 3 0 0 1 5.83 1c0 2-3 3-3 3"/><line x1="12" y1="17" x2="12.01" y2="17"/>' },
+  users: { style: 'stroke', body: '<path d="M17 21v-2a4 4 0 0 0-4-4H5a4 4 0 0 0-4 4v2"/><circle cx="9" cy="7" r="4"/><path d="M23 21v-2a4 4 0 0 0-3-3.87"/><path d="M16 3.13a4 4 0 0 1 0 7.75"/>' },
+
+  // Features
+  target: { style: 'stroke', body: '<circle cx="12" cy="12" r="10"/><circle cx="12" cy="12" r="6"/><circle cx="12" cy="12" r="2"/>' },
+  cloud: { style: 'stroke', body: '<path d="M18 10h-1.26A8 8 0 1 0 9 20h9a5 5 0 0 0 0-10z"/>' },
+  refresh: { style: 'stroke', body: '<path d="M21 2v6h-6"/><path d="M3 12a9 9 0 0 1 15-6.7L21 8"/><path d="M3 22v-6h6"/><path d="M21 12a9 9 0 0 1-15 6.7L3 16"/>' },
+  scale: { style: 'stroke', body: '<rect x="3" y="3" width="18" height="18" rx="2"/><path d="M12 8v8"/><path d="M8 12h8"/>' },
+  shield: { style: 'stroke', body: '<path d="M12 22s8-4 8-10V5l-8-3-8 3v7c0 6 8 10 8 10z"/>' },
+  pulse: { style: 'stroke', body: '<polyline points="22 12 18 12 15 21 9 3 6 12 2 12"/>' },
+  clock: { style: 'stroke', body: '<circle cx="12" cy="12" r="10"/><polyline points="12 6 12 12 16 14"/>' },
+  bolt: { style: 'stroke', body: '<path d="M13 2L3 14h9l-1 8 10-12h-9l1-8z"/>' },
+  machine: { style: 'stroke', body: '<rect x="2" y="4" width="20" height="16" rx="2"/><path d="M6 8h12M6 12h12M6 16h8"/>' },
+  stack: { style: 'stroke', body: '<path d="M12 2L2 7l10 5 10-5-10-5z"/><path d="M2 17l10 5 10-5"/><path d="M2 12l10 5 10-5"/>' },
+
+  // Requirements
+  wrench: { style: 'stroke', body: '<path d="M14.7 6.3a1 1 0 0 0 0 1.4l1.6 1.6a1 1 0 0 0 1.4 0l3.77-3.77a6 6 0 0 1-7.94 7.94l-6.91 6.91a2.12 2.12 0 0 1-3-3l6.91-6.91a6 6 0 0 1 7.94-7.94l-3.76 3.76z"/>' },
+  cpu: { style: 'stroke', body: '<rect x="4" y="4" width="16" height="16" rx="2" ry="2"/><rect x="9" y="9" width="6" height="6"/><line x1="9" y1="1" x2="9" y2="4"/><line x1="15" y1="1" x2="15" y2="4"/><line x1="9" y1="20" x2="9" y2="23"/><line x1="15" y1="20" x2="15" y2="23"/><line x1="20" y1="9" x2="23" y2="9"/><line x1="20" y1="14" x2="23" y2="14"/><line x1="1" y1="9" x2="4" y2="9"/><line x1="1" y1="14" x2="4" y2="14"/>' },
+  wifi: { style: 'stroke', body: '<path d="M5 12.55a11 11 0 0 1 14.08 0"/><path d="M1.42 9a16 16 0 0 1 21.16 0"/><path d="M8.53 16.11a6 6 0 0 1 6.95 0"/><line x1="12" y1="20" x2="12.01" y2="20"/>' },
+} satisfies Record<string, IconDef>;
+
+export type IconName = keyof typeof icons;
+
+const DEFAULT_VIEWBOX = '0 0 24 24';
+
+export function iconViewBox(name: IconName): string {
+  return (icons[name] as IconDef).viewBox ?? DEFAULT_VIEWBOX;
+}
+
+function symbol(name: string, icon: IconDef): string {
+  const paint = icon.style === 'stroke'
+    ? 'fill="none" stroke="currentColor" stroke-width="2" stroke-linecap="round" stroke-linejoin="round"'
+    : 'fill="currentColor"';
+  return `<symbol id="${name}" viewBox="${icon.viewBox ?? DEFAULT_VIEWBOX}"><g ${paint}>${icon.body}</g></symbol>`;
+}
+
+export const sprite = `<svg xmlns="http://www.w3.org/2000/svg">${
+  Object.entries(icons).map(([name, icon]) => symbol(name, icon)).join('')
+}</svg>`;
+
+// Content-hashed so the sprite can be served with an immutable cache policy
+export const spriteUrl = `/icons-${createHash('sha256').update(sprite).digest('hex').slice(0, 10)}.svg`;
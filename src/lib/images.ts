@@ -0,0 +1,89 @@
+// Shared settings for the build-time image pipeline (astro:assets + sharp).
+// Anything that emits a srcset for the same image must go through these
+// helpers so the generated variants line up.
+
+import { getImage } from 'astro:assets';
+import type { ImageMetadata } from 'astro';
+
+export const IMAGE_FORMATS = ['avif', 'webp'] as const;
+
+/**
+ * Widths to generate for an image displayed at `displayWidth` CSS pixels:
+ * 1x and 2x of the display size plus any extra breakpoints, never larger
+ * than the source image itself.
+ */
+export function responsiveWidths(displayWidth: number, intrinsicWidth: number, extra: number[] = []): number[] {
+  const widths = [displayWidth, displayWidth * 2, ...extra]
+    .map(w => Math.min(Math.round(w), intrinsicWidth));
+  return [...new Set(widths)].sort((a, b) => a - b);
+}
+
+/** An image a page declares as its LCP element (BaseLayout's `lcpImage`). */
+export interface LcpImage {
+  src: ImageMetadata;
+  // Same meaning as on ResponsiveImage
+  width: number;
+  widths?: number[];
+  sizes?: string;
+}
+
+/**
+ * Attributes for a `<link rel="preload" as="image">` that matches the first
+ * (preferred format) `<source>` ResponsiveImage renders for the same image,
+ * so the preloaded file is the one the browser then picks.
+ */
+export async function imagePreload({ src, width, widths = [], sizes = `${width}px` }: LcpImage) {
+  const format = IMAGE_FORMATS[0];
+  const image = await getImage({ src, width, widths: responsiveWidths(width, src.width, widths), format });
+  return { imagesrcset: image.srcSet.attribute, imagesizes: sizes, type: `image/${format}` };
+}
+
+// Edge length of the inlined preview, and the Gaussian blur applied over it
+// (in preview pixels) so it scales up smoothly instead of as a blocky smear
+const PLACEHOLDER_SIZE = 16;
+const PLACEHOLDER_BLUR = 1.2;
+
+const placeholders = new Map<string, Promise<string | undefined>>();
+
+async function renderPlaceholder(file: string): Promise<string | undefined> {
+  let sharp;
+  try {
+    sharp = (await import('sharp')).default;
+  } catch {
+    return undefined;
+  }
+  const { isOpaque, dominant } = await sharp(file).stats();
+  const { data, info } = await sharp(file)
+    .resize(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, { fit: 'inside' })
+    .webp({ quality: 40, alphaQuality: 40 })
+    .toBuffer({ resolveWithObject: true });
+
+  // The blur is an SVG filter, so it is applied at display size. Opaque
+  // previews keep full alpha at the edges, which the blur would fade out.
+  const edges = isOpaque
+    ? "<feComponentTransfer><feFuncA type='discrete' tableValues='1 1'/></feComponentTransfer>"
+    : '';
+  const svg =
+    `<svg xmlns='http://www.w3.org/2000/svg' viewBox='0 0 ${info.width} ${info.height}'>` +
+    `<filter id='b' color-interpolation-filters='sRGB'><feGaussianBlur stdDeviation='${PLACEHOLDER_BLUR}'/>${edges}</filter>` +
+    `<image width='100%' height='100%' preserveAspectRatio='none' filter='url(#b)' ` +
+    `href='data:image/webp;base64,${data.toString('base64')}'/></svg>`;
+
+  // Transparent artwork gets no colour block behind it, just its blurred shape
+  const color = isOpaque ? `rgb(${dominant.r} ${dominant.g} ${dominant.b})` : 'transparent';
+  return `background: ${color} url("data:image/svg+xml,${svg.replace(/[<>#%]/g, encodeURIComponent)}") center / cover no-repeat`;
+}
+
+/**
+ * Inline `background` declaration that stands in for an image while it
+ * loads: the dominant colour (opaque images only) under a tiny blurred
+ * preview, computed with sharp once per source image at build time.
+ * Undefined when the source file or sharp isn't available.
+ */
+export function placeholderStyle(src: ImageMetadata): Promise<string | undefined> {
+  // Set (non-enumerable) by Astro on imported images
+  const file = (src as ImageMetadata & { fsPath?: string }).fsPath;
+  if (!file) return Promise.resolve(undefined);
+  if (!placeholders.has(file)) placeholders.set(file, renderPlaceholder(file));
+  return placeholders.get(file)!;
+}
@@ -0,0 +1,79 @@
+// Build-time SVG optimisation for artwork inlined into the HTML.
+//
+// Source files are exported from Illustrator with editor metadata, a
+// <style> block of .stN classes and verbose paths. svgo strips the former,
+// moves the styles onto the shapes (so nothing leaks into the page's CSS)
+// and collapses the paths. Results are memoised per build.
+
+import { readFile } from 'node:fs/promises';
+import { join } from 'node:path';
+import { optimize, type CustomPlugin } from 'svgo';
+
+export interface InlineSvg {
+  viewBox: string;
+  // Markup inside the root <svg>
+  body: string;
+}
+
+export interface InlineSvgOptions {
+  // Prefix for ids (gradients), unique per use on a page
+  idPrefix: string;
+  // Paint every shape in currentColor instead of the artwork's colours
+  monochrome?: boolean;
+}
+
+// Same silhouette as the `filter: brightness(0) invert(1)` trick, but
+// coloured from CSS and without a filter pass. Shapes without a fill
+// inherit currentColor from the root <svg> (see Wordmark.astro).
+const monochrome: CustomPlugin = {
+  name: 'monochrome',
+  fn: () => ({
+    element: {
+      enter(node) {
+        for (const attr of ['fill', 'stroke']) {
+          const value = node.attributes[attr];
+          if (value && value !== 'none') node.attributes[attr] = 'currentColor';
+        }
+      },
+    },
+  }),
+};
+
+const cache = new Map<string, Promise<InlineSvg>>();
+
+async function load(file: string, { idPrefix, monochrome: mono = false }: InlineSvgOptions): Promise<InlineSvg> {
+  const source = await readFile(join(process.cwd(), file), 'utf8');
+  const { data } = optimize(source, {
+    multipass: true,
+    plugins: [
+      {
+        name: 'preset-default',
+        params: { overrides: { inlineStyles: { onlyMatchedOnce: false } } },
+      },
+      'convertStyleToAttrs',
+      ...(mono ? [monochrome, 'cleanupIds' as const, 'removeUselessDefs' as const] : []),
+      { name: 'prefixIds', params: { prefix: idPrefix, delim: '-' } },
+    ],
+  });
+
+  const match = data.match(/^<svg([^>]*)>([\s\S]*)<\/svg>$/);
+  const viewBox = match?.[1].match(/viewBox="([^"]+)"/)?.[1];
+  if (!match || !viewBox) throw new Error(`${file}: expected a single root <svg> with a viewBox`);
+  return { viewBox, body: match[2] };
+}
+
+/** Optimised contents of an SVG file (path relative to the project root). */
+export function inlineSvg(file: string, options: InlineSvgOptions): Promise<InlineSvg> {
+  const key = `${file}|${options.idPrefix}|${options.monochrome ?? false}`;
+  if (!cache.has(key)) cache.set(key, load(file, options));
+  return cache.get(key)!;
+}
+
+// The horizontal BrewOS logo. Each colour variant is defined once per page as
+// a <symbol> (WordmarkSymbols.astro) and drawn with <use> (Wordmark.astro).
+export const WORDMARK_FILE = 'assets/1080/horizontal/full-color/Brewos-01.svg';
+
+/** Id of the wordmark <symbol>, also the prefix for the ids inside it. */
+export function wordmarkSymbolId(monochrome = false): string {
+  return monochrome ? 'wordmark-mono' : 'wordmark';
+}
@@ -0,0 +1,9 @@
+import type { APIRoute, GetStaticPaths } from 'astro';
+import { sprite, spriteUrl } from '../lib/icons';
+
+export const getStaticPaths = (() => [
+  { params: { sprite: spriteUrl.slice(1, -'.svg'.length) } },
+]) satisfies GetStaticPaths;
+
+export const GET: APIRoute = () =>
+  new Response(sprite, { headers: { 'Content-Type': 'image/svg+xml' } });